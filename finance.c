@@ -1,12 +1,29 @@
+#ifdef _WIN32
+#define _CRT_RAND_S // enables rand_s() for the encryption nonce and salt
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <stdint.h>
+#include <stdarg.h>
 
 #define MAX_TRANSACTIONS 100
 #define MAX_CATEGORIES 10
-#define MAX_DEBTS 10 
+#define MAX_DEBTS 10
+#define MAX_LOTS 5000
+#define MAX_ASSETS 50
+#define MAX_PRICES 200000
+
+// Encrypted container (.pfv): header, then chunks of ciphertext + tag
+#define VAULT_MAGIC "PFV1"
+#define VAULT_SALT 16
+#define VAULT_NONCE 8
+#define VAULT_HEADER (4 + VAULT_SALT + VAULT_NONCE)
+#define VAULT_CHUNK 4096
+#define VAULT_TAG 16
+#define VAULT_ITERATIONS 100000
 
 typedef struct {
     char description[100];
@@ -36,12 +53,59 @@ typedef struct {
     float priority;
 } PriorityDebt;
 
+typedef struct {
+    char asset[30];
+    float quantity;
+    float costBasis; // total cost of the lot
+    char date[20]; // YYYY-MM-DD
+} Lot;
+
+typedef struct {
+    int asset; // index into assetNames
+    int day; // days since 1970-01-01
+    float price;
+} PricePoint;
+
+typedef struct {
+    int asset;
+    int day;
+    float quantity;
+    float costBasis;
+} LotEvent;
+
+typedef struct {
+    double holdings;
+    double cash;
+    double debt;
+} NetWorth;
+
+typedef struct {
+    FILE *file;
+    int encrypted;
+    char mode; // 'r' or 'w'
+    unsigned char nonce[VAULT_NONCE];
+    unsigned long chunk; // index of the chunk held in buf
+    unsigned char buf[VAULT_CHUNK + VAULT_TAG];
+    int len, pos, final;
+    char path[40];
+    char temp[48]; // writes go here and replace path only once complete
+    char legacy[40]; // plaintext CSV replaced by this vault
+} DataFile;
+
 // Globals
 Transaction transactions[MAX_TRANSACTIONS];
 Budget budgets[MAX_CATEGORIES];
 Debt debts[MAX_DEBTS];
 PriorityDebt debtQueue[MAX_DEBTS];
 int transaction_count = 0, budget_count = 0, debt_count = 0;
+Lot lots[MAX_LOTS];
+char assetNames[MAX_ASSETS][30];
+PricePoint prices[MAX_PRICES]; // sorted by asset, then day
+int priceFirst[MAX_ASSETS], priceCount[MAX_ASSETS];
+int lot_count = 0, asset_count = 0, price_count = 0;
+int encryption_enabled = 0;
+unsigned char vault_salt[VAULT_SALT];
+unsigned char vault_key[32];
 
 // Function prototypes
 void set_budget();
@@ -61,9 +125,48 @@ void getCurrentDateTime(char *buffer) {
              tm.tm_hour, tm.tm_min, tm.tm_sec);
 }
 
+// Days since 1970-01-01 for a civil date (proleptic Gregorian calendar)
+int days_from_civil(int y, int m, int d) {
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void civil_from_days(int z, int *y, int *m, int *d) {
+    z += 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    *d = doy - (153 * mp + 2) / 5 + 1;
+    *m = mp < 10 ? mp + 3 : mp - 9;
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+// Parses the leading YYYY-MM-DD of a date; returns -1 if it is not a valid date
+int parse_day(const char *date) {
+    int y, m, d;
+    if (sscanf(date, "%d-%d-%d", &y, &m, &d) != 3 || m < 1 || m > 12 || d < 1 || d > 31)
+        return -1;
+    return days_from_civil(y, m, d);
+}
+
+int current_day() {
+    time_t t = time(NULL);
+    struct tm tm = *localtime(&t);
+    return days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+}
+
+float calculate_total_due(Debt d) {
+    return d.principal + (d.principal * d.interestRate / 100.0f) + d.extraFees;
+}
+
 float calculate_monthly_installment(Debt d) {
-    float total = d.principal + (d.principal * d.interestRate / 100.0f) + d.extraFees;
-    return total / d.monthsRemaining;
+    return calculate_total_due(d) / d.monthsRemaining;
 }
 
 void update_debt_payments() {
@@ -85,26 +188,553 @@ void update_debt_payments() {
     }
 }
 
+// Returns the index of an asset (case-insensitive), adding it if add is set; -1 if not found
+int find_asset(const char *name, int add) {
+    char key[30];
+    snprintf(key, sizeof(key), "%.29s", name);
+    normalize(key);
+    for (int i = 0; i < asset_count; i++)
+        if (strcmp(assetNames[i], key) == 0)
+            return i;
+    if (!add || asset_count >= MAX_ASSETS)
+        return -1;
+    strcpy(assetNames[asset_count], key);
+    return asset_count++;
+}
+
+// Encryption (ChaCha20-Poly1305 per RFC 8439, key from PBKDF2-HMAC-SHA256)
+uint32_t load32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void store32(unsigned char *p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+uint32_t rotl32(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+#define QUARTER_ROUND(a, b, c, d) \
+    a += b; d = rotl32(d ^ a, 16); \
+    c += d; b = rotl32(b ^ c, 12); \
+    a += b; d = rotl32(d ^ a, 8);  \
+    c += d; b = rotl32(b ^ c, 7);
+
+void chacha20_block(const unsigned char key[32], uint32_t counter,
+                    const unsigned char nonce[12], unsigned char out[64]) {
+    uint32_t s[16], x[16];
+    s[0] = 0x61707865; s[1] = 0x3320646e; s[2] = 0x79622d32; s[3] = 0x6b206574;
+    for (int i = 0; i < 8; i++)
+        s[4 + i] = load32(key + 4 * i);
+    s[12] = counter;
+    for (int i = 0; i < 3; i++)
+        s[13 + i] = load32(nonce + 4 * i);
+
+    memcpy(x, s, sizeof(x));
+    for (int i = 0; i < 10; i++) {
+        QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; i++)
+        store32(out + 4 * i, x[i] + s[i]);
+}
+
+void chacha20_xor(const unsigned char key[32], uint32_t counter,
+                  const unsigned char nonce[12], unsigned char *data, int len) {
+    unsigned char stream[64];
+    for (int off = 0; off < len; off += 64, counter++) {
+        int n = len - off < 64 ? len - off : 64;
+        chacha20_block(key, counter, nonce, stream);
+        for (int i = 0; i < n; i++)
+            data[off + i] ^= stream[i];
+    }
+}
+
+typedef struct {
+    uint32_t r[5], h[5], pad[4];
+} Poly1305;
+
+void poly1305_init(Poly1305 *p, const unsigned char key[32]) {
+    p->r[0] = load32(key + 0) & 0x3ffffff;
+    p->r[1] = (load32(key + 3) >> 2) & 0x3ffff03;
+    p->r[2] = (load32(key + 6) >> 4) & 0x3ffc0ff;
+    p->r[3] = (load32(key + 9) >> 6) & 0x3f03fff;
+    p->r[4] = (load32(key + 12) >> 8) & 0x00fffff;
+    for (int i = 0; i < 5; i++)
+        p->h[i] = 0;
+    for (int i = 0; i < 4; i++)
+        p->pad[i] = load32(key + 16 + 4 * i);
+}
+
+// Absorbs data zero-padded to a multiple of 16 bytes, as the AEAD construction requires
+void poly1305_update(Poly1305 *p, const unsigned char *data, int len) {
+    uint32_t r0 = p->r[0], r1 = p->r[1], r2 = p->r[2], r3 = p->r[3], r4 = p->r[4];
+    uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = p->h[0], h1 = p->h[1], h2 = p->h[2], h3 = p->h[3], h4 = p->h[4];
+    unsigned char block[16];
+
+    for (int off = 0; off < len; off += 16) {
+        const unsigned char *m = data + off;
+        if (len - off < 16) {
+            memset(block, 0, sizeof(block));
+            memcpy(block, m, len - off);
+            m = block;
+        }
+        h0 += load32(m + 0) & 0x3ffffff;
+        h1 += (load32(m + 3) >> 2) & 0x3ffffff;
+        h2 += (load32(m + 6) >> 4) & 0x3ffffff;
+        h3 += (load32(m + 9) >> 6) & 0x3ffffff;
+        h4 += (load32(m + 12) >> 8) | (1 << 24);
+
+        uint64_t d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 + (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+        uint64_t d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 + (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+        uint64_t d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 + (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+        uint64_t d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 + (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+        uint64_t d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 + (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+        uint32_t c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3ffffff;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3ffffff;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3ffffff;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3ffffff;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+        h1 += c;
+    }
+    p->h[0] = h0; p->h[1] = h1; p->h[2] = h2; p->h[3] = h3; p->h[4] = h4;
+}
+
+void poly1305_finish(Poly1305 *p, unsigned char tag[16]) {
+    uint32_t h0 = p->h[0], h1 = p->h[1], h2 = p->h[2], h3 = p->h[3], h4 = p->h[4];
+    uint32_t c;
+    c = h1 >> 26; h1 &= 0x3ffffff;
+    h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+    h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+    h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+    h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+    h1 += c;
+
+    // Compute h - p and keep it if it did not underflow
+    uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+    uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+    uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+    uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+    uint32_t g4 = h4 + c - (1 << 26);
+    uint32_t mask = (g4 >> 31) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+    h3 = (h3 & ~mask) | (g3 & mask);
+    h4 = (h4 & ~mask) | (g4 & mask);
+
+    uint64_t f;
+    f = (uint64_t)(h0 | (h1 << 26)) + p->pad[0];              store32(tag + 0, (uint32_t)f);
+    f = (uint64_t)((h1 >> 6) | (h2 << 20)) + p->pad[1] + (f >> 32); store32(tag + 4, (uint32_t)f);
+    f = (uint64_t)((h2 >> 12) | (h3 << 14)) + p->pad[2] + (f >> 32); store32(tag + 8, (uint32_t)f);
+    f = (uint64_t)((h3 >> 18) | (h4 << 8)) + p->pad[3] + (f >> 32); store32(tag + 12, (uint32_t)f);
+}
+
+// ChaCha20-Poly1305 AEAD: encrypts (or decrypts) data in place and computes its tag
+void chacha20_poly1305(const unsigned char key[32], const unsigned char nonce[12],
+                       const unsigned char *aad, int aadLen, unsigned char *data, int len,
+                       unsigned char tag[16], int decrypt) {
+    unsigned char block[64], lengths[16];
+    Poly1305 mac;
+
+    chacha20_block(key, 0, nonce, block);
+    poly1305_init(&mac, block);
+    if (!decrypt)
+        chacha20_xor(key, 1, nonce, data, len);
+    poly1305_update(&mac, aad, aadLen);
+    poly1305_update(&mac, data, len);
+    store32(lengths + 0, (uint32_t)aadLen); store32(lengths + 4, 0);
+    store32(lengths + 8, (uint32_t)len); store32(lengths + 12, 0);
+    poly1305_update(&mac, lengths, 16);
+    poly1305_finish(&mac, tag);
+    if (decrypt)
+        chacha20_xor(key, 1, nonce, data, len);
+}
+
+// Encrypts (or decrypts) one vault chunk.
+// The final flag is the associated data, so a truncated file fails to verify.
+void aead_chunk(unsigned char *data, int len, unsigned char final,
+                const unsigned char nonce[12], unsigned char tag[16], int decrypt) {
+    chacha20_poly1305(vault_key, nonce, &final, 1, data, len, tag, decrypt);
+}
+
+typedef struct {
+    uint32_t h[8];
+    unsigned char buf[64];
+    uint64_t total;
+    int used;
+} Sha256;
+
+const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+void sha256_compress(Sha256 *s, const unsigned char *block) {
+    uint32_t w[64], v[8];
+    for (int i = 0; i < 16; i++)
+        w[i] = ((uint32_t)block[4 * i] << 24) | ((uint32_t)block[4 * i + 1] << 16) |
+               ((uint32_t)block[4 * i + 2] << 8) | block[4 * i + 3];
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotl32(w[i - 15], 25) ^ rotl32(w[i - 15], 14) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotl32(w[i - 2], 15) ^ rotl32(w[i - 2], 13) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    memcpy(v, s->h, sizeof(v));
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = v[7] + (rotl32(v[4], 26) ^ rotl32(v[4], 21) ^ rotl32(v[4], 7)) +
+                      ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha256_k[i] + w[i];
+        uint32_t t2 = (rotl32(v[0], 30) ^ rotl32(v[0], 19) ^ rotl32(v[0], 10)) +
+                      ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        memmove(v + 1, v, 7 * sizeof(uint32_t));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+    for (int i = 0; i < 8; i++)
+        s->h[i] += v[i];
+}
+
+void sha256_init(Sha256 *s) {
+    const uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(s->h, iv, sizeof(iv));
+    s->total = 0;
+    s->used = 0;
+}
+
+void sha256_update(Sha256 *s, const unsigned char *data, int len) {
+    s->total += len;
+    for (int i = 0; i < len; i++) {
+        s->buf[s->used++] = data[i];
+        if (s->used == 64) {
+            sha256_compress(s, s->buf);
+            s->used = 0;
+        }
+    }
+}
+
+void sha256_final(Sha256 *s, unsigned char out[32]) {
+    uint64_t bits = s->total * 8;
+    unsigned char pad = 0x80, zero = 0, length[8];
+    sha256_update(s, &pad, 1);
+    while (s->used != 56)
+        sha256_update(s, &zero, 1);
+    for (int i = 0; i < 8; i++)
+        length[i] = bits >> (56 - 8 * i);
+    sha256_update(s, length, 8);
+    for (int i = 0; i < 8; i++) {
+        out[4 * i] = s->h[i] >> 24; out[4 * i + 1] = s->h[i] >> 16;
+        out[4 * i + 2] = s->h[i] >> 8; out[4 * i + 3] = s->h[i];
+    }
+}
+
+// PBKDF2-HMAC-SHA256 producing a single 32-byte block
+void derive_key(const char *passphrase, const unsigned char *salt, int saltLen,
+                int iterations, unsigned char out[32]) {
+    unsigned char key[64] = {0}, pad[64], u[32], one[4] = {0, 0, 0, 1};
+    Sha256 inner, outer, s;
+    int keylen = strlen(passphrase);
+
+    if (keylen > 64) {
+        sha256_init(&s);
+        sha256_update(&s, (const unsigned char *)passphrase, keylen);
+        sha256_final(&s, key);
+    } else {
+        memcpy(key, passphrase, keylen);
+    }
+    for (int i = 0; i < 64; i++) pad[i] = key[i] ^ 0x36;
+    sha256_init(&inner);
+    sha256_update(&inner, pad, 64);
+    for (int i = 0; i < 64; i++) pad[i] = key[i] ^ 0x5c;
+    sha256_init(&outer);
+    sha256_update(&outer, pad, 64);
+
+    s = inner;
+    sha256_update(&s, salt, saltLen);
+    sha256_update(&s, one, 4);
+    sha256_final(&s, u);
+    s = outer;
+    sha256_update(&s, u, 32);
+    sha256_final(&s, u);
+    memcpy(out, u, 32);
+
+    for (int n = 1; n < iterations; n++) {
+        s = inner;
+        sha256_update(&s, u, 32);
+        sha256_final(&s, u);
+        s = outer;
+        sha256_update(&s, u, 32);
+        sha256_final(&s, u);
+        for (int i = 0; i < 32; i++)
+            out[i] ^= u[i];
+    }
+    memset(key, 0, sizeof(key));
+    memset(pad, 0, sizeof(pad));
+}
+
+int random_bytes(unsigned char *buf, int len) {
+#ifdef _WIN32
+    for (int i = 0; i < len; i++) {
+        unsigned int r;
+        if (rand_s(&r) != 0) return 0;
+        buf[i] = (unsigned char)r;
+    }
+    return 1;
+#else
+    FILE *file = fopen("/dev/urandom", "rb");
+    if (!file) return 0;
+    int ok = fread(buf, 1, len, file) == (size_t)len;
+    fclose(file);
+    return ok;
+#endif
+}
+
+// Chunk nonce: chunk index followed by the per-file random nonce
+void vault_nonce(const DataFile *f, unsigned long index, unsigned char nonce[12]) {
+    store32(nonce, (uint32_t)index);
+    memcpy(nonce + 4, f->nonce, VAULT_NONCE);
+}
+
+int vault_write_chunk(DataFile *f, int final) {
+    unsigned char nonce[12];
+    vault_nonce(f, f->chunk, nonce);
+    aead_chunk(f->buf, f->len, final, nonce, f->buf + f->len, 0);
+    int ok = fwrite(f->buf, 1, f->len + VAULT_TAG, f->file) == (size_t)(f->len + VAULT_TAG);
+    f->chunk++;
+    f->len = 0;
+    return ok;
+}
+
+// Reads and verifies a single chunk; chunks have a fixed size, so any chunk can be
+// fetched directly without decrypting the ones before it.
+int vault_read_chunk(DataFile *f, unsigned long index) {
+    unsigned char nonce[12], tag[16], diff = 0;
+    long offset = VAULT_HEADER + (long)index * (VAULT_CHUNK + VAULT_TAG);
+
+    // Sequential reads are already positioned at the next chunk
+    if (index != f->chunk + 1 && fseek(f->file, offset, SEEK_SET) != 0) return 0;
+    int got = fread(f->buf, 1, VAULT_CHUNK + VAULT_TAG, f->file);
+    f->chunk = index;
+    if (got < VAULT_TAG) return 0;
+
+    f->len = got - VAULT_TAG;
+    f->pos = 0;
+    f->final = got < VAULT_CHUNK + VAULT_TAG;
+    vault_nonce(f, index, nonce);
+    memcpy(tag, f->buf + f->len, VAULT_TAG);
+    aead_chunk(f->buf, f->len, f->final, nonce, f->buf + f->len, 1);
+    for (int i = 0; i < VAULT_TAG; i++)
+        diff |= tag[i] ^ f->buf[f->len + i];
+    return diff == 0;
+}
+
+int read_vault_salt(const char *path, unsigned char salt[VAULT_SALT]) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return 0;
+    unsigned char header[VAULT_HEADER];
+    int ok = fread(header, 1, VAULT_HEADER, file) == VAULT_HEADER &&
+             memcmp(header, VAULT_MAGIC, 4) == 0;
+    if (ok) memcpy(salt, header + 4, VAULT_SALT);
+    fclose(file);
+    return ok;
+}
+
+void unlock_vault() {
+    const char *files[] = {"transactions.pfv", "budgets.pfv", "debts.pfv", "investments.pfv"};
+    char passphrase[100] = "";
+    int existing = 0;
+
+    for (int i = 0; i < 4 && !existing; i++)
+        existing = read_vault_salt(files[i], vault_salt);
+
+    const char *env = getenv("FINANCE_PASSPHRASE");
+    if (env) {
+        snprintf(passphrase, sizeof(passphrase), "%s", env);
+    } else {
+        printf("Passphrase (leave blank to keep plaintext CSV files): ");
+        if (fgets(passphrase, sizeof(passphrase), stdin))
+            passphrase[strcspn(passphrase, "\n")] = '\0';
+    }
+
+    if (strlen(passphrase) == 0) {
+        if (existing) {
+            printf("Encrypted data found. A passphrase is required.\n");
+            exit(1);
+        }
+        return;
+    }
+
+    if (!existing && !random_bytes(vault_salt, VAULT_SALT)) {
+        printf("Error: no random source for encryption!\n");
+        exit(1);
+    }
+    derive_key(passphrase, vault_salt, VAULT_SALT, VAULT_ITERATIONS, vault_key);
+    memset(passphrase, 0, sizeof(passphrase));
+    encryption_enabled = 1;
+}
+
+// Saving over data that failed to decrypt would destroy it, so stop here instead
+void vault_failed(const char *path) {
+    printf("Error: cannot decrypt %s (wrong passphrase or corrupted file)!\n", path);
+    exit(1);
+}
+
 // File Handling
+// Opens "<name>.pfv" when encryption is enabled, otherwise "<name>.csv".
+// An existing plaintext CSV is still read so it can be migrated into a vault.
+// Writes go to "<path>.tmp", which data_close() renames over the real file.
+DataFile *data_open(const char *name, char mode) {
+    DataFile *f = calloc(1, sizeof(DataFile));
+    if (!f) return NULL;
+    f->mode = mode;
+    snprintf(f->legacy, sizeof(f->legacy), "%s.csv", name);
+    snprintf(f->path, sizeof(f->path), "%s.%s", name, encryption_enabled ? "pfv" : "csv");
+    snprintf(f->temp, sizeof(f->temp), "%s.tmp", f->path);
+
+    if (encryption_enabled) {
+        f->file = fopen(mode == 'w' ? f->temp : f->path, mode == 'w' ? "wb" : "rb");
+        if (f->file) {
+            unsigned char header[VAULT_HEADER];
+            f->encrypted = 1;
+            if (mode == 'w') {
+                memcpy(header, VAULT_MAGIC, 4);
+                memcpy(header + 4, vault_salt, VAULT_SALT);
+                if (!random_bytes(f->nonce, VAULT_NONCE) ||
+                    fwrite(header, 1, 4 + VAULT_SALT, f->file) != 4 + VAULT_SALT ||
+                    fwrite(f->nonce, 1, VAULT_NONCE, f->file) != VAULT_NONCE) {
+                    fclose(f->file);
+                    remove(f->temp);
+                    f->file = NULL;
+                }
+            } else if (fread(header, 1, VAULT_HEADER, f->file) == VAULT_HEADER &&
+                       memcmp(header, VAULT_MAGIC, 4) == 0) {
+                memcpy(f->nonce, header + 4 + VAULT_SALT, VAULT_NONCE);
+                f->chunk = (unsigned long)-1; // positioned just before chunk 0
+                if (!vault_read_chunk(f, 0)) vault_failed(f->path);
+            } else {
+                vault_failed(f->path);
+            }
+        } else if (mode == 'r') {
+            f->file = fopen(f->legacy, "r");
+        }
+    } else {
+        f->file = fopen(mode == 'w' ? f->temp : f->path, mode == 'w' ? "w" : "r");
+    }
+
+    if (!f->file) {
+        free(f);
+        return NULL;
+    }
+    return f;
+}
+
+char *data_gets(char *line, int size, DataFile *f) {
+    if (!f->encrypted)
+        return fgets(line, size, f->file);
+
+    int n = 0;
+    while (n < size - 1) {
+        if (f->pos == f->len) {
+            if (f->final) break;
+            if (!vault_read_chunk(f, f->chunk + 1)) vault_failed(f->path);
+            continue;
+        }
+        unsigned char *start = f->buf + f->pos;
+        int avail = f->len - f->pos;
+        if (avail > size - 1 - n) avail = size - 1 - n;
+        unsigned char *end = memchr(start, '\n', avail);
+        int take = end ? (int)(end - start) + 1 : avail;
+        memcpy(line + n, start, take);
+        n += take;
+        f->pos += take;
+        if (end) break;
+    }
+    if (n == 0) return NULL;
+    line[n] = '\0';
+    return line;
+}
+
+void data_printf(DataFile *f, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    if (!f->encrypted) {
+        vfprintf(f->file, format, args);
+        va_end(args);
+        return;
+    }
+
+    char text[512];
+    int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (n > (int)sizeof(text) - 1) n = sizeof(text) - 1;
+    for (int i = 0; i < n; i++) {
+        f->buf[f->len++] = text[i];
+        if (f->len == VAULT_CHUNK && !vault_write_chunk(f, 0))
+            f->final = -1; // remember the write error for data_close
+    }
+}
+
+// Returns 0 if the file could not be fully written; the previous copy is then left intact
+int data_close(DataFile *f) {
+    int ok = 1;
+    if (f->mode == 'w') {
+        if (f->encrypted)
+            ok = f->final != -1 && vault_write_chunk(f, 1);
+        ok = fclose(f->file) == 0 && ok;
+#ifdef _WIN32
+        // rename() does not replace an existing file on Windows
+        if (ok) remove(f->path);
+#endif
+        ok = ok && rename(f->temp, f->path) == 0;
+        if (!ok)
+            remove(f->temp);
+        else if (f->encrypted)
+            remove(f->legacy);
+    } else {
+        fclose(f->file);
+    }
+    memset(f, 0, sizeof(DataFile));
+    free(f);
+    return ok;
+}
+
 void save_transactions() {
-    FILE *file = fopen("transactions.csv", "w");
+    DataFile *file = data_open("transactions", 'w');
     if (!file) {
         printf("Error saving transactions!\n");
         return;
     }
     for (int i = 0; i < transaction_count; i++) {
         Transaction t = transactions[i];
-        fprintf(file, "%s,%.2f,%c,%s,%s\n", t.description, t.amount, t.type, t.category, t.date);
+        data_printf(file, "%s,%.2f,%c,%s,%s\n", t.description, t.amount, t.type, t.category, t.date);
     }
-    fclose(file);
+    if (!data_close(file))
+        printf("Error saving transactions!\n");
 }
 
 void load_transactions() {
-    FILE *file = fopen("transactions.csv", "r");
+    DataFile *file = data_open("transactions", 'r');
     if (!file) return;
 
     char line[256];
-    while (fgets(line, sizeof(line), file)) {
+    while (data_gets(line, sizeof(line), file)) {
         Transaction t;
         char *token = strtok(line, ",");
         if (!token) continue;
@@ -129,28 +759,29 @@ void load_transactions() {
         if (transaction_count < MAX_TRANSACTIONS)
             transactions[transaction_count++] = t;
     }
-    fclose(file);
+    data_close(file);
 }
 
 void save_budgets() {
-    FILE *file = fopen("budgets.csv", "w");
+    DataFile *file = data_open("budgets", 'w');
     if (!file) {
         printf("Error saving budgets!\n");
         return;
     }
     for (int i = 0; i < budget_count; i++) {
         Budget b = budgets[i];
-        fprintf(file, "%s,%.2f,%.2f\n", b.category, b.budget, b.spent);
+        data_printf(file, "%s,%.2f,%.2f\n", b.category, b.budget, b.spent);
     }
-    fclose(file);
+    if (!data_close(file))
+        printf("Error saving budgets!\n");
 }
 
 void load_budgets() {
-    FILE *file = fopen("budgets.csv", "r");
+    DataFile *file = data_open("budgets", 'r');
     if (!file) return;
 
     char line[256];
-    while (fgets(line, sizeof(line), file)) {
+    while (data_gets(line, sizeof(line), file)) {
         Budget b;
         char *token = strtok(line, ",");
         if (!token) continue;
@@ -167,30 +798,31 @@ void load_budgets() {
         if (budget_count < MAX_CATEGORIES)
             budgets[budget_count++] = b;
     }
-    fclose(file);
+    data_close(file);
 }
 
 void save_debts() {
-    FILE *file = fopen("debts.csv", "w");
+    DataFile *file = data_open("debts", 'w');
     if (!file) {
         printf("Error saving debts!\n");
         return;
     }
     for (int i = 0; i < debt_count; i++) {
         Debt d = debts[i];
-        fprintf(file, "%s,%.2f,%d,%.2f,%.2f,%.2f\n", 
+        data_printf(file, "%s,%.2f,%d,%.2f,%.2f,%.2f\n", 
                 d.name, d.principal, d.monthsRemaining, 
                 d.interestRate, d.extraFees, d.paid);
     }
-    fclose(file);
+    if (!data_close(file))
+        printf("Error saving debts!\n");
 }
 
 void load_debts() {
-    FILE *file = fopen("debts.csv", "r");
+    DataFile *file = data_open("debts", 'r');
     if (!file) return;
 
     char line[256];
-    while (fgets(line, sizeof(line), file)) {
+    while (data_gets(line, sizeof(line), file)) {
         Debt d;
         char *token = strtok(line, ",");
         if (!token) continue;
@@ -223,7 +855,120 @@ void load_debts() {
             debt_count++;
         }
     }
-    fclose(file);
+    data_close(file);
+}
+
+void save_lots() {
+    DataFile *file = data_open("investments", 'w');
+    if (!file) {
+        printf("Error saving investments!\n");
+        return;
+    }
+    for (int i = 0; i < lot_count; i++) {
+        Lot l = lots[i];
+        data_printf(file, "%s,%.4f,%.2f,%s\n", l.asset, l.quantity, l.costBasis, l.date);
+    }
+    if (!data_close(file))
+        printf("Error saving investments!\n");
+}
+
+void load_lots() {
+    DataFile *file = data_open("investments", 'r');
+    if (!file) return;
+
+    char line[256];
+    int skipped = 0;
+    while (data_gets(line, sizeof(line), file)) {
+        Lot l;
+        char *token = strtok(line, ",");
+        if (!token) continue;
+        snprintf(l.asset, sizeof(l.asset), "%s", token);
+
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        l.quantity = atof(token);
+
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        l.costBasis = atof(token);
+
+        token = strtok(NULL, "\n");
+        if (!token || parse_day(token) < 0) continue;
+        snprintf(l.date, sizeof(l.date), "%s", token);
+
+        if (lot_count < MAX_LOTS && find_asset(l.asset, 1) >= 0)
+            lots[lot_count++] = l;
+        else
+            skipped++;
+    }
+    data_close(file);
+
+    if (skipped > 0)
+        printf("Lot or asset limit reached! %d investment lots were not loaded.\n", skipped);
+}
+
+int compare_prices(const void *a, const void *b) {
+    const PricePoint *x = a, *y = b;
+    if (x->asset != y->asset) return x->asset - y->asset;
+    return x->day - y->day;
+}
+
+// Sorts prices by asset and day and records where each asset's history starts
+void index_prices() {
+    qsort(prices, price_count, sizeof(PricePoint), compare_prices);
+    memset(priceCount, 0, sizeof(priceCount));
+    for (int i = price_count - 1; i >= 0; i--) {
+        priceFirst[prices[i].asset] = i;
+        priceCount[prices[i].asset]++;
+    }
+}
+
+// Price history is supplied by the user as "asset,YYYY-MM-DD,price" lines in prices.csv
+void load_prices() {
+    DataFile *file = data_open("prices", 'r');
+    if (!file) return;
+
+    char line[256];
+    int asset = -1, noAsset = 0, noRoom = 0;
+    char last[30] = "";
+    while (data_gets(line, sizeof(line), file)) {
+        char *token = strtok(line, ",");
+        if (!token) continue;
+        // Histories are usually grouped by asset, so skip the lookup for repeated names
+        if (asset < 0 || strcmp(token, last) != 0) {
+            snprintf(last, sizeof(last), "%s", token);
+            asset = find_asset(last, 1);
+        }
+
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        int day = parse_day(token);
+
+        token = strtok(NULL, "\n");
+        if (!token || day < 0) continue;
+
+        if (asset < 0) {
+            noAsset++;
+        } else if (price_count >= MAX_PRICES) {
+            noRoom++;
+        } else {
+            prices[price_count].asset = asset;
+            prices[price_count].day = day;
+            prices[price_count].price = atof(token);
+            price_count++;
+        }
+    }
+    data_close(file);
+
+    // Skipped rows leave holdings valued at cost or at a stale price, so say so
+    if (noAsset > 0)
+        printf("Asset limit reached! %d price rows for assets beyond the first %d were skipped.\n",
+               noAsset, MAX_ASSETS);
+    if (noRoom > 0)
+        printf("Price limit reached! %d price rows beyond the first %d were skipped.\n",
+               noRoom, MAX_PRICES);
+
+    index_prices();
 }
 
 // Core functions
@@ -600,10 +1345,7 @@ void display_debts() {
     }
 
     for (int i = 0; i < debt_count; i++) {
-        float total_due = debts[i].principal + 
-                         (debts[i].principal * debts[i].interestRate / 100.0f) + 
-                          debts[i].extraFees;
-        float remaining = total_due - debts[i].paid;
+        float remaining = calculate_total_due(debts[i]) - debts[i].paid;
         printf("%s | Principal: Rs %.2f | Installment: Rs %.2f/mo | Paid: Rs %.2f | Remaining: Rs %.2f | Months: %d\n",
                debts[i].name, debts[i].principal, 
                calculate_monthly_installment(debts[i]), 
@@ -637,6 +1379,307 @@ void display_top_debts() {
     }
 }
 
+void add_lot() {
+    if (lot_count >= MAX_LOTS) {
+        printf("Lot limit reached!\n");
+        return;
+    }
+
+    Lot l;
+    printf("Asset: ");
+    getchar(); fgets(l.asset, sizeof(l.asset), stdin);
+    l.asset[strcspn(l.asset, "\n")] = '\0';
+    if (strlen(l.asset) == 0) {
+        printf("Asset cannot be empty.\n");
+        return;
+    }
+
+    printf("Quantity: ");
+    if (scanf("%f", &l.quantity) != 1 || l.quantity <= 0) {
+        printf("Invalid quantity.\n");
+        while(getchar() != '\n');
+        return;
+    }
+
+    printf("Total cost: ");
+    if (scanf("%f", &l.costBasis) != 1 || l.costBasis < 0) {
+        printf("Invalid cost.\n");
+        while(getchar() != '\n');
+        return;
+    }
+
+    printf("Purchase date (YYYY-MM-DD, blank for today): ");
+    getchar(); fgets(l.date, sizeof(l.date), stdin);
+    l.date[strcspn(l.date, "\n")] = '\0';
+    if (strlen(l.date) == 0) {
+        getCurrentDateTime(l.date);
+        l.date[10] = '\0';
+    } else if (parse_day(l.date) < 0) {
+        printf("Invalid date.\n");
+        return;
+    }
+
+    if (find_asset(l.asset, 1) < 0) {
+        printf("Asset limit reached!\n");
+        return;
+    }
+    lots[lot_count++] = l;
+    printf("Lot added!\n");
+}
+
+// Lists the lots of one asset and asks which one to use; returns its index or -1
+int choose_lot(const char *action) {
+    char asset[30];
+    printf("Enter asset to %s: ", action);
+    getchar(); fgets(asset, sizeof(asset), stdin);
+    asset[strcspn(asset, "\n")] = '\0';
+
+    int a = find_asset(asset, 0), shown = 0;
+    for (int i = 0; i < lot_count && a >= 0; i++) {
+        if (find_asset(lots[i].asset, 0) != a) continue;
+        printf("%d. %s | Qty: %.4f | Cost: Rs %.2f | Date: %s\n",
+               i + 1, lots[i].asset, lots[i].quantity, lots[i].costBasis, lots[i].date);
+        shown++;
+    }
+    if (shown == 0) {
+        printf("Asset not found.\n");
+        return -1;
+    }
+
+    int number;
+    printf("Lot number: ");
+    if (scanf("%d", &number) != 1 || number < 1 || number > lot_count ||
+        find_asset(lots[number - 1].asset, 0) != a) {
+        printf("Invalid lot.\n");
+        while(getchar() != '\n');
+        return -1;
+    }
+    return number - 1;
+}
+
+void edit_lot() {
+    if (lot_count == 0) {
+        printf("No lots to edit.\n");
+        return;
+    }
+
+    int i = choose_lot("edit");
+    if (i < 0) return;
+
+    Lot l = lots[i];
+    printf("New quantity (current %.4f): ", l.quantity);
+    if (scanf("%f", &l.quantity) != 1 || l.quantity <= 0) {
+        printf("Invalid quantity.\n");
+        while(getchar() != '\n');
+        return;
+    }
+
+    printf("New total cost (current Rs %.2f): ", l.costBasis);
+    if (scanf("%f", &l.costBasis) != 1 || l.costBasis < 0) {
+        printf("Invalid cost.\n");
+        while(getchar() != '\n');
+        return;
+    }
+
+    char date[20];
+    printf("New purchase date (current %s, blank to keep): ", l.date);
+    getchar(); fgets(date, sizeof(date), stdin);
+    date[strcspn(date, "\n")] = '\0';
+    if (strlen(date) > 0) {
+        if (parse_day(date) < 0) {
+            printf("Invalid date.\n");
+            return;
+        }
+        strcpy(l.date, date);
+    }
+
+    lots[i] = l;
+    printf("Lot updated.\n");
+}
+
+// Removes a lot entirely, e.g. one entered by mistake or fully sold
+void delete_lot() {
+    if (lot_count == 0) {
+        printf("No lots to delete.\n");
+        return;
+    }
+
+    int i = choose_lot("delete");
+    if (i < 0) return;
+
+    for (int j = i; j < lot_count - 1; j++)
+        lots[j] = lots[j + 1];
+    lot_count--;
+    printf("Lot deleted.\n");
+}
+
+// Index of the latest price for an asset on or before day, or -1 if none
+int find_price(int asset, int day) {
+    int lo = priceFirst[asset], hi = lo + priceCount[asset] - 1, found = -1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (prices[mid].day <= day) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+void display_holdings() {
+    printf("\n===== HOLDINGS =====\n");
+    if (lot_count == 0) {
+        printf("No holdings.\n");
+        return;
+    }
+
+    int lotsHeld[MAX_ASSETS] = {0};
+    float quantity[MAX_ASSETS] = {0}, cost[MAX_ASSETS] = {0};
+    for (int i = 0; i < lot_count; i++) {
+        int a = find_asset(lots[i].asset, 0);
+        lotsHeld[a]++;
+        quantity[a] += lots[i].quantity;
+        cost[a] += lots[i].costBasis;
+    }
+
+    int today = current_day();
+    float total_value = 0, total_cost = 0;
+    for (int a = 0; a < asset_count; a++) {
+        if (lotsHeld[a] == 0) continue;
+        int p = find_price(a, today);
+        // Without a price history the holding is valued at cost
+        float value = p < 0 ? cost[a] : quantity[a] * prices[p].price;
+        if (p < 0)
+            printf("%s | Lots: %d | Qty: %.4f | Cost: Rs %.2f | Price: n/a | Value: Rs %.2f\n",
+                   assetNames[a], lotsHeld[a], quantity[a], cost[a], value);
+        else
+            printf("%s | Lots: %d | Qty: %.4f | Cost: Rs %.2f | Price: Rs %.2f | Value: Rs %.2f | Gain: Rs %.2f\n",
+                   assetNames[a], lotsHeld[a], quantity[a], cost[a], prices[p].price, value, value - cost[a]);
+        total_value += value;
+        total_cost += cost[a];
+    }
+    printf("\nTotal Value: Rs %.2f\nTotal Cost: Rs %.2f\nUnrealized Gain: Rs %.2f\n",
+           total_value, total_cost, total_value - total_cost);
+}
+
+int compare_lot_events(const void *a, const void *b) {
+    const LotEvent *x = a, *y = b;
+    if (x->asset != y->asset) return x->asset - y->asset;
+    return x->day - y->day;
+}
+
+// Builds the daily net worth from the first lot or transaction up to today.
+// Every source records only the days on which it changes, and a single prefix-sum
+// pass turns those deltas into running totals, so the cost is O(days + lots + prices)
+// instead of revaluing everything on each day.
+NetWorth *net_worth_series(int *start, int *days) {
+    static LotEvent events[MAX_LOTS];
+    int today = current_day(), first = today;
+
+    for (int i = 0; i < lot_count; i++) {
+        events[i].asset = find_asset(lots[i].asset, 0);
+        events[i].day = parse_day(lots[i].date);
+        events[i].quantity = lots[i].quantity;
+        events[i].costBasis = lots[i].costBasis;
+        if (events[i].day < first) first = events[i].day;
+    }
+    for (int i = 0; i < transaction_count; i++) {
+        int day = parse_day(transactions[i].date);
+        if (day >= 0 && day < first) first = day;
+    }
+
+    int n = today - first + 1;
+    NetWorth *s = calloc(n, sizeof(NetWorth));
+    if (!s) return NULL;
+
+    // Debt starts at the total due and falls with each repayment, as in display_debts()
+    for (int i = 0; i < debt_count; i++)
+        s[0].debt += calculate_total_due(debts[i]);
+    for (int i = 0; i < transaction_count; i++) {
+        int d = parse_day(transactions[i].date) - first;
+        if (d < 0 || d >= n) continue;
+        if (transactions[i].type == 'I') {
+            s[d].cash += transactions[i].amount;
+            continue;
+        }
+        s[d].cash -= transactions[i].amount;
+
+        char category[30];
+        strcpy(category, transactions[i].category);
+        normalize(category);
+        for (int j = 0; j < debt_count; j++) {
+            char debtName[30];
+            strcpy(debtName, debts[j].name);
+            normalize(debtName);
+            if (strcmp(category, debtName) == 0)
+                s[d].debt -= transactions[i].amount;
+        }
+    }
+
+    // Holdings: walk each asset's lots and prices together in date order and record
+    // the change in its value at every point where the quantity or price changes
+    qsort(events, lot_count, sizeof(LotEvent), compare_lot_events);
+    for (int e = 0; e < lot_count; ) {
+        int asset = events[e].asset, end = e;
+        while (end < lot_count && events[end].asset == asset) end++;
+
+        int p = priceFirst[asset], pend = p + priceCount[asset], priced = 0;
+        double quantity = 0, cost = 0, price = 0, value = 0;
+        while (e < end || p < pend) {
+            int day = e < end ? events[e].day : prices[p].day;
+            if (p < pend && prices[p].day < day) day = prices[p].day;
+            if (day - first >= n) break;
+
+            for (; e < end && events[e].day == day; e++) {
+                quantity += events[e].quantity;
+                cost += events[e].costBasis;
+            }
+            for (; p < pend && prices[p].day == day; p++) {
+                price = prices[p].price;
+                priced = 1;
+            }
+            // Holdings are valued at cost until the first known price
+            double newValue = priced ? quantity * price : cost;
+            int d = day < first ? 0 : day - first;
+            s[d].holdings += newValue - value;
+            value = newValue;
+        }
+        e = end;
+    }
+
+    for (int d = 1; d < n; d++) {
+        s[d].holdings += s[d - 1].holdings;
+        s[d].cash += s[d - 1].cash;
+        s[d].debt += s[d - 1].debt;
+    }
+    *start = first;
+    *days = n;
+    return s;
+}
+
+void display_net_worth() {
+    int start, days;
+    NetWorth *s = net_worth_series(&start, &days);
+    if (!s) {
+        printf("Not enough memory for net worth history!\n");
+        return;
+    }
+
+    // Show the year-end values and today
+    printf("\n===== NET WORTH =====\n");
+    for (int d = 0; d < days; d++) {
+        int y, m, dd;
+        civil_from_days(start + d, &y, &m, &dd);
+        if ((m == 12 && dd == 31) || d == days - 1)
+            printf("%04d-%02d-%02d | Holdings: Rs %.2f | Cash: Rs %.2f | Debt: Rs %.2f | Net Worth: Rs %.2f\n",
+                   y, m, dd, s[d].holdings, s[d].cash, s[d].debt,
+                   s[d].holdings + s[d].cash - s[d].debt);
+    }
+    free(s);
+}
+
 void menu() {
     int choice;
     do {
@@ -652,7 +1695,12 @@ void menu() {
         printf("9. Delete Debt\n");
         printf("10. View Debts\n");
         printf("11. View Priority Debts\n");
-        printf("12. Save & Exit\n");
+        printf("12. Add Investment Lot\n");
+        printf("13. Edit Investment Lot\n");
+        printf("14. Delete Investment Lot\n");
+        printf("15. View Holdings\n");
+        printf("16. View Net Worth\n");
+        printf("17. Save & Exit\n");
         printf("Choice: ");
         scanf("%d", &choice);
 
@@ -668,20 +1716,32 @@ void menu() {
             case 9: delete_debt(); break;
             case 10: display_debts(); break;
             case 11: display_top_debts(); break;
-            case 12: printf("Saving data...\n"); break;
+            case 12: add_lot(); break;
+            case 13: edit_lot(); break;
+            case 14: delete_lot(); break;
+            case 15: display_holdings(); break;
+            case 16: display_net_worth(); break;
+            case 17: printf("Saving data...\n"); break;
             default: printf("Invalid option.\n");
         }
-    } while (choice != 12);
+    } while (choice != 17);
 }
 
+// Defined by the programs in tests/, which include this file for its functions
+#ifndef FINANCE_NO_MAIN
 int main() {
+    unlock_vault();
     load_transactions();
     load_budgets();
     load_debts();
+    load_lots();
+    load_prices();
     menu();
     save_transactions();
     save_budgets();
     save_debts();
+    save_lots();
     printf("Data saved. Exiting...\n");
     return 0;
 }
+#endif
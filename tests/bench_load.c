@@ -0,0 +1,62 @@
+// Benchmark: plaintext vs encrypted load of a full ledger (MAX_TRANSACTIONS rows).
+// Run it from an empty directory, since it writes transactions.csv/.pfv there:
+//   gcc -std=c99 -O2 -o bench_load tests/bench_load.c && ./bench_load
+#define _POSIX_C_SOURCE 199309L
+#define FINANCE_NO_MAIN
+#include "../finance.c"
+
+#define RUNS 20000
+
+double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+double time_loads() {
+    double start = now();
+    for (int i = 0; i < RUNS; i++) {
+        transaction_count = 0;
+        load_transactions();
+    }
+    return (now() - start) / RUNS;
+}
+
+int main() {
+    FILE *existing = fopen("transactions.csv", "r");
+    if (!existing) existing = fopen("transactions.pfv", "rb");
+    if (existing) {
+        fclose(existing);
+        printf("Refusing to run: transactions data exists in this directory.\n");
+        return 1;
+    }
+
+    for (int i = 0; i < MAX_TRANSACTIONS; i++) {
+        Transaction t;
+        snprintf(t.description, sizeof(t.description), "Transaction number %d for the benchmark", i);
+        t.amount = 10.0f + i * 3.25f;
+        t.type = i % 3 ? 'E' : 'I';
+        snprintf(t.category, sizeof(t.category), "category%d", i % 8);
+        snprintf(t.date, sizeof(t.date), "2026-%02d-%02d 10:00:00", i % 12 + 1, i % 28 + 1);
+        transactions[i] = t;
+    }
+    transaction_count = MAX_TRANSACTIONS;
+    save_transactions();
+    double plain = time_loads();
+
+    memset(vault_salt, 0, VAULT_SALT);
+    double start = now();
+    derive_key("benchmark passphrase", vault_salt, VAULT_SALT, VAULT_ITERATIONS, vault_key);
+    double kdf = now() - start;
+    encryption_enabled = 1;
+    save_transactions(); // also removes transactions.csv
+    double encrypted = time_loads();
+    remove("transactions.pfv");
+
+    printf("Rows loaded:          %d\n", transaction_count);
+    printf("Plaintext load:       %.1f us\n", plain * 1e6);
+    printf("Encrypted load:       %.1f us\n", encrypted * 1e6);
+    printf("Overhead per load:    %.1f us (%.0f%%)\n", (encrypted - plain) * 1e6, (encrypted / plain - 1) * 100);
+    printf("Key derivation (once at startup): %.1f ms\n", kdf * 1e3);
+    return 0;
+}
@@ -0,0 +1,140 @@
+// Benchmark and self-check for net_worth_series(): 20 years of daily prices,
+// MAX_LOTS lots and a full ledger, checked against a per-day brute-force valuation.
+// Build and run from the repository root (it reads and writes no files):
+//   gcc -std=c99 -O2 -o bench_net_worth tests/bench_net_worth.c && ./bench_net_worth
+#define _POSIX_C_SOURCE 199309L
+#define FINANCE_NO_MAIN
+#include "../finance.c"
+
+#define YEARS 20
+#define PRICED_ASSETS 18
+#define ALL_ASSETS 20 // the last two have no price history and are valued at cost
+
+unsigned int seed = 12345;
+
+double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+double absolute(double x) {
+    return x < 0 ? -x : x;
+}
+
+double random_unit() {
+    seed = seed * 1103515245u + 12345u;
+    return ((seed >> 8) & 0xffffff) / (double)0x1000000;
+}
+
+void format_day(int day, char *buffer, int size) {
+    int y, m, d;
+    civil_from_days(day, &y, &m, &d);
+    snprintf(buffer, size, "%04d-%02d-%02d", y, m, d);
+}
+
+// Net worth on one day, recomputed from scratch
+double brute_force(int day) {
+    double total = 0;
+    for (int a = 0; a < asset_count; a++) {
+        double quantity = 0, cost = 0;
+        for (int i = 0; i < lot_count; i++) {
+            if (find_asset(lots[i].asset, 0) == a && parse_day(lots[i].date) <= day) {
+                quantity += lots[i].quantity;
+                cost += lots[i].costBasis;
+            }
+        }
+        int p = find_price(a, day);
+        total += p < 0 ? cost : quantity * prices[p].price;
+    }
+    for (int i = 0; i < debt_count; i++)
+        total -= calculate_total_due(debts[i]);
+    for (int i = 0; i < transaction_count; i++) {
+        if (parse_day(transactions[i].date) > day) continue;
+        if (transactions[i].type == 'I') {
+            total += transactions[i].amount;
+        } else {
+            total -= transactions[i].amount;
+            if (strcmp(transactions[i].category, "car loan") == 0)
+                total += transactions[i].amount;
+        }
+    }
+    return total;
+}
+
+int main() {
+    int today = current_day(), first = today - YEARS * 365;
+
+    for (int a = 0; a < ALL_ASSETS; a++) {
+        char name[30];
+        snprintf(name, sizeof(name), "asset%d", a);
+        find_asset(name, 1);
+    }
+    for (int a = 0; a < PRICED_ASSETS; a++) {
+        double price = 100;
+        for (int day = first; day <= today; day++) {
+            price *= 1 + (random_unit() - 0.49) * 0.02;
+            prices[price_count].asset = a;
+            prices[price_count].day = day;
+            prices[price_count].price = price;
+            price_count++;
+        }
+    }
+    index_prices();
+
+    for (int i = 0; i < MAX_LOTS; i++) {
+        snprintf(lots[i].asset, sizeof(lots[i].asset), "asset%d", (int)(random_unit() * ALL_ASSETS));
+        lots[i].quantity = 0.1 + random_unit() * 5;
+        lots[i].costBasis = 10 + random_unit() * 500;
+        format_day(first + (int)(random_unit() * (today - first)), lots[i].date, sizeof(lots[i].date));
+    }
+    lot_count = MAX_LOTS;
+
+    strcpy(debts[0].name, "car loan");
+    debts[0].principal = 20000;
+    debts[0].monthsRemaining = 48;
+    debts[0].interestRate = 8;
+    debts[0].extraFees = 500;
+    debt_count = 1;
+    for (int i = 0; i < MAX_TRANSACTIONS; i++) {
+        Transaction t;
+        snprintf(t.description, sizeof(t.description), "entry %d", i);
+        t.amount = 10 + random_unit() * 2000;
+        t.type = i % 3 ? 'E' : 'I';
+        strcpy(t.category, i % 4 == 1 ? "car loan" : "general");
+        format_day(first + (int)(random_unit() * (today - first)), t.date, sizeof(t.date));
+        strcat(t.date, " 10:00:00");
+        transactions[i] = t;
+    }
+    transaction_count = MAX_TRANSACTIONS;
+
+    int start, days;
+    double begin = now();
+    NetWorth *series = net_worth_series(&start, &days);
+    double elapsed = now() - begin;
+    if (!series) {
+        printf("Not enough memory for net worth history!\n");
+        return 1;
+    }
+
+    int checked = 0, mismatches = 0;
+    for (int d = 0; d < days; d += 37, checked++) {
+        double expected = brute_force(start + d);
+        double actual = series[d].holdings + series[d].cash - series[d].debt;
+        if (absolute(actual - expected) > 1e-6 * (1 + absolute(expected))) {
+            if (mismatches++ < 5)
+                printf("Mismatch on day %d: %.2f vs %.2f\n", d, actual, expected);
+        }
+    }
+    free(series);
+
+    printf("Days: %d | Lots: %d | Prices: %d | Transactions: %d\n", days, lot_count, price_count, transaction_count);
+    printf("Series built in %.2f ms\n", elapsed * 1e3);
+    printf("Brute-force check: %d of %d sampled days mismatched\n", mismatches, checked);
+    if (mismatches > 0 || elapsed >= 1.0) {
+        printf("FAIL\n");
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Known-answer tests for the encryption code in finance.c.
+// Build and run from the repository root:
+//   gcc -std=c99 -O2 -o test_crypto tests/test_crypto.c && ./test_crypto
+#define FINANCE_NO_MAIN
+#include "../finance.c"
+
+int failures = 0;
+
+void check(const char *name, int ok) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", name);
+    if (!ok) failures++;
+}
+
+// RFC 8439 section 2.8.2 AEAD test vector
+void test_rfc8439_aead() {
+    const char *plaintext = "Ladies and Gentlemen of the class of '99: If I could offer you only one "
+                            "tip for the future, sunscreen would be it.";
+    const unsigned char nonce[12] = {0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47};
+    const unsigned char aad[12] = {0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7};
+    const unsigned char ciphertext[114] = {
+        0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc,
+        0x53, 0xef, 0x7e, 0xc2, 0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+        0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6, 0x3d, 0xbe, 0xa4, 0x5e,
+        0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+        0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6,
+        0x7e, 0xcd, 0x3b, 0x36, 0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+        0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58, 0xfa, 0xb3, 0x24, 0xe4,
+        0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+        0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65,
+        0x86, 0xce, 0xc6, 0x4b, 0x61, 0x16
+    };
+    const unsigned char tag[16] = {
+        0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91
+    };
+    unsigned char key[32], data[114], computed[16];
+    for (int i = 0; i < 32; i++)
+        key[i] = 0x80 + i;
+
+    memcpy(data, plaintext, 114);
+    chacha20_poly1305(key, nonce, aad, 12, data, 114, computed, 0);
+    check("RFC 8439 2.8.2 ciphertext", memcmp(data, ciphertext, 114) == 0);
+    check("RFC 8439 2.8.2 tag", memcmp(computed, tag, 16) == 0);
+
+    chacha20_poly1305(key, nonce, aad, 12, data, 114, computed, 1);
+    check("RFC 8439 2.8.2 decrypt", memcmp(data, plaintext, 114) == 0 && memcmp(computed, tag, 16) == 0);
+
+    memcpy(data, ciphertext, 114);
+    data[50] ^= 1;
+    chacha20_poly1305(key, nonce, aad, 12, data, 114, computed, 1);
+    check("RFC 8439 2.8.2 tampered ciphertext rejected", memcmp(computed, tag, 16) != 0);
+}
+
+void test_sha256_and_pbkdf2() {
+    const unsigned char abc[32] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    };
+    // RFC 7914 section 11: PBKDF2-HMAC-SHA256("passwd", "salt", 1), first 32 bytes
+    const unsigned char pbkdf2[32] = {
+        0x55, 0xac, 0x04, 0x6e, 0x56, 0xe3, 0x08, 0x9f, 0xec, 0x16, 0x91, 0xc2, 0x25, 0x44, 0xb6, 0x05,
+        0xf9, 0x41, 0x85, 0x21, 0x6d, 0xde, 0x04, 0x65, 0xe6, 0x8b, 0x9d, 0x57, 0xc2, 0x0d, 0xac, 0xbc
+    };
+    unsigned char out[32];
+    Sha256 s;
+
+    sha256_init(&s);
+    sha256_update(&s, (const unsigned char *)"abc", 3);
+    sha256_final(&s, out);
+    check("SHA-256 \"abc\"", memcmp(out, abc, 32) == 0);
+
+    derive_key("passwd", (const unsigned char *)"salt", 4, 1, out);
+    check("PBKDF2-HMAC-SHA256 RFC 7914", memcmp(out, pbkdf2, 32) == 0);
+}
+
+// Writes a multi-chunk vault, reads it back, and checks that damage is detected
+void test_vault_file() {
+    char line[256];
+    int lines = 0, ok = 1;
+
+    for (int i = 0; i < 32; i++)
+        vault_key[i] = i;
+    memset(vault_salt, 0, VAULT_SALT);
+    encryption_enabled = 1;
+
+    DataFile *f = data_open("test_vault", 'w');
+    for (int i = 0; i < 600; i++)
+        data_printf(f, "row %d,%.2f\n", i, i * 1.5);
+    check("vault write", data_close(f));
+
+    f = data_open("test_vault", 'r');
+    while (data_gets(line, sizeof(line), f)) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "row %d,%.2f\n", lines, lines * 1.5);
+        ok = ok && strcmp(line, expected) == 0;
+        lines++;
+    }
+    check("vault round trip", ok && lines == 600 && f->chunk == 2);
+    check("vault random access to chunk 1", vault_read_chunk(f, 1) && f->len == VAULT_CHUNK && !f->final);
+    check("vault random access back to chunk 0", vault_read_chunk(f, 0) && memcmp(f->buf, "row 0,", 6) == 0);
+    data_close(f);
+
+    // Flip one ciphertext byte in the second chunk, then cut off the final chunk
+    FILE *file = fopen("test_vault.pfv", "r+b");
+    long offset = VAULT_HEADER + VAULT_CHUNK + VAULT_TAG + 10;
+    fseek(file, offset, SEEK_SET);
+    int c = fgetc(file);
+    fseek(file, offset, SEEK_SET);
+    fputc(c ^ 1, file);
+    fclose(file);
+    f = data_open("test_vault", 'r');
+    check("vault tampered chunk rejected", !vault_read_chunk(f, 1));
+    check("vault untouched chunk still readable", vault_read_chunk(f, 0));
+    data_close(f);
+
+    char data[VAULT_HEADER + VAULT_CHUNK + VAULT_TAG];
+    file = fopen("test_vault.pfv", "rb");
+    int size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    file = fopen("test_vault.pfv", "wb");
+    fwrite(data, 1, size, file);
+    fclose(file);
+    f = data_open("test_vault", 'r');
+    check("vault truncated at chunk boundary rejected", !vault_read_chunk(f, 1));
+    data_close(f);
+
+    remove("test_vault.pfv");
+    encryption_enabled = 0;
+}
+
+int main() {
+    test_rfc8439_aead();
+    test_sha256_and_pbkdf2();
+    test_vault_file();
+    printf("%s\n", failures ? "Some tests failed." : "All tests passed.");
+    return failures ? 1 : 0;
+}